@@ -0,0 +1,109 @@
+#include "data_structures.h"
+#include "graph_ops.h"
+#include "mcmf_solver.h"
+#include "contingency.h"
+#include "solution_cache.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+/**
+ * Builds a random network: about a third of the places are sources, a third are
+ * sinks (random priority), the rest are junctions; pipes join random pairs.
+ */
+static void make_random_network(int num_places, int num_pipes, unsigned seed,
+                                vector<Place>& places, ConnectionList& connections) {
+    mt19937 rng(seed);
+    auto pick = [&](int lo, int hi) { return uniform_int_distribution<int>(lo, hi)(rng); };
+
+    places.clear();
+    connections.clear();
+    for (int i = 0; i < num_places; ++i) {
+        int role = pick(0, 2);
+        int balance = (role == 0) ? pick(50, 200) : (role == 1 ? -pick(50, 200) : 0);
+        places.push_back({i, "P" + to_string(i), balance, pick(1, 5), "None"});
+    }
+    for (int i = 0; i < num_pipes; ++i) {
+        int u = pick(0, num_places - 1);
+        int v = pick(0, num_places - 2);
+        if (v >= u) v++; // No self-loops
+        connections.emplace_back(u, v, pick(10, 100), pick(1, 50));
+    }
+}
+
+static double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Usage: h2o_bench [places] [pipes] [seed]
+ * Times one full solve against the N-1 contingency analysis of the same network,
+ * then cold vs warm-started solves after changing some pipe capacities.
+ */
+int main(int argc, char* argv[]) {
+    int num_places = (argc > 1) ? atoi(argv[1]) : 300;
+    int num_pipes = (argc > 2) ? atoi(argv[2]) : 1500;
+    unsigned seed = (argc > 3) ? (unsigned)atoi(argv[3]) : 1;
+
+    vector<Place> places;
+    ConnectionList connections;
+    make_random_network(num_places, num_pipes, seed, places, connections);
+    const int SUPER_SOURCE = num_places;
+    const int SUPER_SINK = num_places + 1;
+
+    cout << "Network: " << num_places << " places, " << num_pipes << " pipes, seed " << seed
+         << ", " << thread::hardware_concurrency() << " hardware threads" << endl;
+
+    // 1. One cold solve
+    auto start = chrono::steady_clock::now();
+    WaterNetwork graph = build_water_network(places, connections);
+    int total_flow = 0;
+    int total_cost = min_cost_max_flow(graph, SUPER_SOURCE, SUPER_SINK, total_flow);
+    double solve_time = seconds_since(start);
+    cout << "One solve:        " << solve_time << " s (flow " << total_flow << ", cost " << total_cost << ")" << endl;
+
+    // 2. N-1 contingency analysis on the solved graph
+    start = chrono::steady_clock::now();
+    vector<OutageResult> results = evaluate_pipe_outages(graph, connections, SUPER_SOURCE, SUPER_SINK);
+    double outage_time = seconds_since(start);
+
+    int evaluated = 0;
+    for (const auto& r : results) evaluated += r.evaluated;
+    cout << "N-1 analysis:     " << outage_time << " s (" << evaluated << " of " << results.size()
+         << " pipes carry flow)" << endl;
+    cout << "N-1 / one solve:  " << outage_time / solve_time << "x" << endl;
+
+    // 3. Warm start from the solved network after changing a share of the capacities
+    CachedSolution cached;
+    capture_solution_flows(graph, cached);
+
+    for (int percent : {5, 20, 50}) {
+        ConnectionList changed = connections;
+        mt19937 rng(seed + percent);
+        for (auto& conn : changed) {
+            if (uniform_int_distribution<int>(1, 100)(rng) <= percent) {
+                get<2>(conn) = uniform_int_distribution<int>(10, 100)(rng);
+            }
+        }
+
+        start = chrono::steady_clock::now();
+        WaterNetwork cold = build_water_network(places, changed);
+        int cold_flow = 0;
+        int cold_cost = min_cost_max_flow(cold, SUPER_SOURCE, SUPER_SINK, cold_flow);
+        double cold_time = seconds_since(start);
+
+        start = chrono::steady_clock::now();
+        WaterNetwork warm = build_water_network(places, changed);
+        int warm_flow = 0, warm_cost = 0;
+        bool warm_ok = warm_start_solve(warm, cached, SUPER_SOURCE, SUPER_SINK, warm_flow, warm_cost);
+        double warm_time = seconds_since(start);
+
+        cout << percent << "% capacities changed: cold " << cold_time << " s, warm " << warm_time << " s"
+             << ((warm_ok && warm_flow == cold_flow && warm_cost == cold_cost) ? "" : " (MISMATCH)") << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,35 @@
+#ifndef CONTINGENCY_H
+#define CONTINGENCY_H
+
+#include "data_structures.h"
+using namespace std;
+
+/**
+ *  Effect of a single pipe failing, relative to the base distribution plan.
+ */
+struct OutageResult {
+    int connection_index;   // Index into the ConnectionList
+    int base_pipe_flow;     // Flow the pipe carried in the base plan
+    int flow_achieved;      // Total water distributed with the pipe out of service
+    int total_cost;         // Minimum distribution cost with the pipe out of service
+    bool evaluated;         // false if skipped (no flow, nothing changes) or the repair failed
+};
+
+/**
+ *  Evaluates every single-pipe outage (N-1) against a solved network.
+ *  Each outage is repaired from a copy of the solved residual graph with Dijkstra on
+ *  reduced costs rather than re-solved, and outages are evaluated in parallel.
+ *  base_graph The solved graph produced by run_analysis.
+ *  s, t Super source and super sink IDs.
+ *  One result per connection, in ConnectionList order.
+ */
+vector<OutageResult> evaluate_pipe_outages(const WaterNetwork& base_graph, const ConnectionList& connections,
+                                           int s, int t);
+
+/**
+ *  Runs the N-1 contingency analysis and prints pipes ranked by unmet-demand impact.
+ */
+void report_pipe_outages(const vector<Place>& places, const ConnectionList& connections,
+                         const WaterNetwork& graph, int s, int t);
+
+#endif // CONTINGENCY_H
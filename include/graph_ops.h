@@ -2,6 +2,7 @@
 #define GRAPH_OPS_H
 
 #include "data_structures.h"
+#include <utility>
 
 /**
  *  Adds a forward edge (u -> v) and its reverse edge (v -> u) to the graph.
@@ -13,4 +14,26 @@
  */
 void add_edge(WaterNetwork& graph, int u, int v, int cap, int cost);
 
+/**
+ *  Builds the full network: every pipe, a super source (ID places.size()) feeding each
+ *  surplus place, and a super sink (ID places.size() + 1) fed by each deficit place at
+ *  its priority penalty cost.
+ */
+WaterNetwork build_water_network(const vector<Place>& places, const ConnectionList& connections);
+
+/**
+ *  Totals of a plan: water leaving the super source s and the cost of all flow.
+ *  total_flow, total_cost Output parameters.
+ */
+void compute_plan_totals(const WaterNetwork& graph, int s, int& total_flow, int& total_cost);
+
+/**
+ *  Finds a path from u to target following only forward edges that carry flow (flow > 0).
+ *  path Output parameter for the path as (node, edge index in graph[node]) steps.
+ *  avoid Optional node the path must not pass through (-1 for none).
+ *  true if a path was found, false otherwise.
+ */
+bool find_flow_carrying_path(const WaterNetwork& graph, int u, int target,
+                             vector<pair<int, int>>& path, int avoid = -1);
+
 #endif // GRAPH_OPS_H
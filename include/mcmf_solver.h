@@ -18,4 +18,20 @@ PathResult bellman_ford_shortest_path(WaterNetwork& graph, int s, int t,
  */
 int min_cost_max_flow(WaterNetwork& graph, int s, int t, int& max_flow_result);
 
+/**
+ *  Computes node potentials (shortest residual distances from a virtual root
+ *  connected to every node) for a graph with no negative-cost cycles.
+ */
+vector<int> compute_node_potentials(const WaterNetwork& graph);
+
+/**
+ *  Repairs a flow whose edges or capacities were changed after solving: routes every
+ *  excess/shortage at a place (to another place, or back to s/t), then augments to
+ *  maximum flow. Uses Dijkstra on reduced costs instead of Bellman-Ford.
+ *  potentials Must give every residual edge a non-negative reduced cost
+ *  (cost + p[u] - p[v]); kept valid as flow is pushed.
+ *  false if an imbalance could not be routed (the flow was inconsistent).
+ */
+bool rebalance_and_augment(WaterNetwork& graph, int s, int t, vector<long long>& potentials);
+
 #endif // MCMF_SOLVER_H
@@ -0,0 +1,87 @@
+#ifndef SOLUTION_CACHE_H
+#define SOLUTION_CACHE_H
+
+#include "data_structures.h"
+#include <cstdint>
+using namespace std;
+
+// Directory where solved networks are stored, one file per content hash.
+const string SOLUTION_CACHE_DIR = "./code/.solution_cache";
+
+// Bump whenever the solver or the cache file layout changes, so old entries are ignored.
+const int SOLUTION_CACHE_VERSION = 2;
+
+// Upper bounds on sizes read from a cache file; anything larger is treated as damaged.
+const size_t MAX_CACHED_NODES = 1000000;
+const size_t MAX_CACHED_DEGREE = 1000000;
+const size_t MAX_CACHED_INPUT_BYTES = 64 * 1024 * 1024;
+
+/**
+ *  A solved network as stored on disk.
+ */
+struct CachedSolution {
+    uint64_t content_key = 0;   // Hash of places, connections and solver parameters
+    uint64_t topology_key = 0;  // Same, but ignoring capacities and balance amounts
+    int total_flow_achieved = 0;
+    int min_total_cost = 0;
+    string network_input;       // The serialized input the content key was computed from
+    vector<vector<int>> flows;  // Flow on every adjacency entry (same layout as the graph)
+    vector<int> potentials;     // Node potentials of the final residual graph
+};
+
+/**
+ *  Serializes everything that determines the solution: places, connections and solver parameters.
+ */
+string describe_network_input(const vector<Place>& places, const ConnectionList& connections);
+
+/**
+ *  Hashes the output of describe_network_input.
+ */
+uint64_t compute_content_key(const string& network_input);
+
+/**
+ *  Hashes only the shape of the network (edges, costs, which places are sources/sinks).
+ *  Networks with equal topology keys build identical adjacency layouts.
+ */
+uint64_t compute_topology_key(const vector<Place>& places, const ConnectionList& connections);
+
+/**
+ *  Loads the solution stored for exactly this network input.
+ *  true on a cache hit, false otherwise.
+ */
+bool load_exact_solution(const string& cache_dir, const string& network_input, CachedSolution& solution);
+
+/**
+ *  Loads the most recent solution of a network with the same topology (for warm starts).
+ *  true if one was found, false otherwise.
+ */
+bool load_warm_start_solution(const string& cache_dir, uint64_t topology_key, CachedSolution& solution);
+
+/**
+ *  Stores a solution under both its content key and its topology key.
+ *  true if written successfully, false otherwise.
+ */
+bool save_solution(const string& cache_dir, const CachedSolution& solution);
+
+/**
+ *  Copies the cached flows onto a freshly built graph with the same layout.
+ *  false if the layouts do not match or the flows are not a valid plan with the
+ *  stored summary (graph is left untouched).
+ */
+bool apply_cached_flows(WaterNetwork& graph, const CachedSolution& solution, int s, int t);
+
+/**
+ *  Records the graph's flows and node potentials into a solution for saving.
+ */
+void capture_solution_flows(const WaterNetwork& graph, CachedSolution& solution);
+
+/**
+ *  Solves a freshly built graph starting from the cached solution of a network with
+ *  the same topology, repairing it with Dijkstra on the stored potentials.
+ *  total_flow, total_cost Output parameters for the solved plan.
+ *  false if the cached solution does not fit this graph (graph is left at zero flow).
+ */
+bool warm_start_solve(WaterNetwork& graph, const CachedSolution& solution, int s, int t,
+                      int& total_flow, int& total_cost);
+
+#endif // SOLUTION_CACHE_H
@@ -1,6 +1,8 @@
 #include "analysis.h"
 #include "graph_ops.h"
 #include "mcmf_solver.h"
+#include "solution_cache.h"
+#include "contingency.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -8,30 +10,6 @@
 
 using namespace std;
 
-// --- Helper for DFS traversal (used in calculate_specific_transfer_cost) ---
-bool find_flow_path(const WaterNetwork& graph, int u, int target_v, 
-                    int& current_flow, int& current_cost, vector<bool>& visited) {
-    if (u == target_v) return true;
-
-    visited[u] = true;
-
-    for (const auto& edge : graph[u]) {
-        // Only follow edges that have positive flow and are forward edges (cost >= 0)
-        if (edge.flow > 0 && edge.cost >= 0 && !visited[edge.to_place]) {
-            
-            // Recursively find the path
-            if (find_flow_path(graph, edge.to_place, target_v, current_flow, current_cost, visited)) {
-                // Path found: update flow and cost along the way back
-                current_flow = min(current_flow, edge.flow);
-                current_cost += edge.flow * edge.cost;
-                return true;
-            }
-        }
-    }
-    visited[u] = false; // Backtrack
-    return false;
-}
-
 // --- Query Implementations ---
 
 /**
@@ -64,10 +42,15 @@ void calculate_specific_transfer_cost(const vector<Place>& places, const WaterNe
     // Try to find a single path with flow from source to sink
     int total_flow = INT_MAX; 
     int total_cost = 0;
-    vector<bool> visited(graph.size(), false);
+    vector<pair<int, int>> path;
 
     // This is a simplified query; a full flow tracing requires more complex graph analysis
-    if (find_flow_path(graph, surplus_id, deficit_id, total_flow, total_cost, visited)) {
+    if (find_flow_carrying_path(graph, surplus_id, deficit_id, path)) {
+        for (const auto& step : path) {
+            const auto& edge = graph[step.first][step.second];
+            total_flow = min(total_flow, edge.flow);
+            total_cost += edge.flow * edge.cost;
+        }
         cout << "\n--- Specific Transfer Path Analysis ---\n";
         cout << "From: " << places[surplus_id].name << " -> To: " << places[deficit_id].name << endl;
         cout << "  Flow Found: **" << total_flow << " KL** (Represents bottleneck flow on one path)" << endl;
@@ -177,46 +160,63 @@ void run_analysis(vector<Place>& places, ConnectionList& connections) {
     const size_t NUM_PLACES = places.size();
     const int SUPER_SOURCE = NUM_PLACES;
     const int SUPER_SINK = NUM_PLACES + 1;
-    const int TOTAL_NODES = NUM_PLACES + 2;
 
-    WaterNetwork graph(TOTAL_NODES);
-
-    // 2. Add Road/Pipe Connections
-    for (const auto& conn : connections) {
-        add_edge(graph, get<0>(conn), get<1>(conn), get<2>(conn), get<3>(conn));
-    }
+    // 2. Add Road/Pipe Connections and Super Source / Super Sink Connections (Priority Integration)
+    WaterNetwork graph = build_water_network(places, connections);
 
-    // 3. Add Super Source / Super Sink Connections (Priority Integration)
+    // 3. Totals for the summary
     int total_required = 0;
     int total_available = 0;
 
     for (const auto& p : places) {
-        if (p.deficit_or_surplus > 0) { // Surplus node: Connect to Super Source
+        if (p.deficit_or_surplus > 0) {
             total_available += p.deficit_or_surplus;
-            add_edge(graph, SUPER_SOURCE, p.id, p.deficit_or_surplus, 0);
-        } else if (p.deficit_or_surplus < 0) { // Deficit node: Connect to Super Sink
+        } else if (p.deficit_or_surplus < 0) {
             total_required += abs(p.deficit_or_surplus);
-            int required_amount = abs(p.deficit_or_surplus);
-            
-            // Priority Cost: Lower priority (5) means higher cost/penalty
-            int priority_cost = (p.priority_level - 1) * PRIORITY_PENALTY; 
-            
-            add_edge(graph, p.id, SUPER_SINK, required_amount, priority_cost);
         }
     }
 
     cout << "\n--- WATER DISTRIBUTION ANALYSIS (MCMF) ---" << endl;
     cout << "Total Required: " << total_required << " KL | Total Available: " << total_available << " KL" << endl;
 
-    // 4. Run MCMF
+    // 4. Run MCMF (or reuse a cached solution of the same network)
     int total_flow_achieved = 0;
-    int min_total_cost = min_cost_max_flow(graph, SUPER_SOURCE, SUPER_SINK, total_flow_achieved);
+    int min_total_cost = 0;
+
+    CachedSolution cached;
+    string network_input = describe_network_input(places, connections);
+    uint64_t content_key = compute_content_key(network_input);
+    uint64_t topology_key = compute_topology_key(places, connections);
+
+    if (load_exact_solution(SOLUTION_CACHE_DIR, network_input, cached) &&
+        apply_cached_flows(graph, cached, SUPER_SOURCE, SUPER_SINK)) {
+        total_flow_achieved = cached.total_flow_achieved;
+        min_total_cost = cached.min_total_cost;
+        cout << "Loaded cached solution (no re-solve needed)." << endl;
+    } else {
+        if (load_warm_start_solution(SOLUTION_CACHE_DIR, topology_key, cached) &&
+            warm_start_solve(graph, cached, SUPER_SOURCE, SUPER_SINK, total_flow_achieved, min_total_cost)) {
+            cout << "Warm start from cached solution of a similar network." << endl;
+        } else {
+            min_total_cost = min_cost_max_flow(graph, SUPER_SOURCE, SUPER_SINK, total_flow_achieved);
+        }
+
+        // Store the result so later runs on the same data can skip the solve
+        CachedSolution solved;
+        solved.content_key = content_key;
+        solved.topology_key = topology_key;
+        solved.network_input = network_input;
+        solved.total_flow_achieved = total_flow_achieved;
+        solved.min_total_cost = min_total_cost;
+        capture_solution_flows(graph, solved);
+        save_solution(SOLUTION_CACHE_DIR, solved);
+    }
 
     // 5. Output Results
     cout << "--------------------------------------------------------" << endl;
     cout << "Max Flow Achieved (Water Distributed): **" << total_flow_achieved << " KL**" << endl;
     cout << "Minimum Distribution Cost: **$" << min_total_cost << "**" << endl;
-    cout < "Cost includes priority penalties.)" << endl;
+    cout << "(Cost includes priority penalties.)" << endl;
     cout << "--------------------------------------------------------" << endl;
     
     // --- Post-Analysis Queries ---
@@ -228,6 +228,7 @@ void run_analysis(vector<Place>& places, ConnectionList& connections) {
         cout << "2. Identify Bottlenecks\n";
         cout << "3. Crop Suggestions Report\n";
         cout << "4. Return to Main Menu\n";
+        cout << "5. N-1 Pipe Outage Contingency Report\n";
         cout << "Enter query choice: ";
         cin >> query_choice;
 
@@ -248,6 +249,9 @@ void run_analysis(vector<Place>& places, ConnectionList& connections) {
             case 4:
                 cout << "Returning to Main Menu." << endl;
                 break;
+            case 5:
+                report_pipe_outages(places, connections, graph, SUPER_SOURCE, SUPER_SINK);
+                break;
             default:
                 cout << "Invalid query choice." << endl;
         }
@@ -0,0 +1,151 @@
+#include "contingency.h"
+#include "graph_ops.h"
+#include "mcmf_solver.h"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+// --- Helpers ---
+
+// Position of each connection's forward edge in graph[u], replaying the order add_edge was called in.
+static vector<int> locate_connection_edges(const ConnectionList& connections, size_t num_nodes) {
+    vector<int> next_index(num_nodes, 0);
+    vector<int> edge_index;
+    for (const auto& conn : connections) {
+        int u = get<0>(conn), v = get<1>(conn);
+        edge_index.push_back(next_index[u]++);
+        next_index[v]++; // Reverse edge
+    }
+    return edge_index;
+}
+
+// --- Contingency Analysis ---
+
+/**
+ * Repairs one outage on a private copy of the solved graph: close the pipe and drop
+ * its flow, which leaves an excess at its start and a shortage at its end. Those are
+ * rerouted along shortest residual paths using the base potentials, so the plan stays
+ * optimal without re-solving. If the imbalance cannot be routed the result is left
+ * unevaluated rather than guessed.
+ */
+static OutageResult evaluate_outage(const WaterNetwork& base_graph, const vector<long long>& base_potentials,
+                                    int connection_index, int u, int edge_idx, int s, int t) {
+    WaterNetwork graph = base_graph;
+    vector<long long> potentials = base_potentials;
+    OutageResult result = {connection_index, base_graph[u][edge_idx].flow, 0, 0, false};
+
+    // Closing the pipe removes both of its residual edges, so the potentials stay valid
+    auto& pipe = graph[u][edge_idx];
+    graph[pipe.to_place][pipe.reverse_edge].flow = 0;
+    pipe.flow = 0;
+    pipe.capacity = 0;
+
+    if (!rebalance_and_augment(graph, s, t, potentials)) return result;
+
+    result.evaluated = true;
+    compute_plan_totals(graph, s, result.flow_achieved, result.total_cost);
+    return result;
+}
+
+/**
+ * Skips pipes without flow (their outage leaves the optimal plan unchanged) and
+ * spreads the remaining outages over worker threads, one graph copy per outage.
+ * The base graph and potentials are shared read-only.
+ */
+vector<OutageResult> evaluate_pipe_outages(const WaterNetwork& base_graph, const ConnectionList& connections,
+                                           int s, int t) {
+    vector<int> edge_index = locate_connection_edges(connections, base_graph.size());
+
+    // One Bellman-Ford pass for the whole analysis; every outage starts from these read-only
+    vector<int> node_potentials = compute_node_potentials(base_graph);
+    vector<long long> base_potentials(node_potentials.begin(), node_potentials.end());
+
+    vector<OutageResult> results(connections.size());
+    vector<int> pending;
+
+    for (size_t i = 0; i < connections.size(); ++i) {
+        int u = get<0>(connections[i]);
+        int flow = base_graph[u][edge_index[i]].flow;
+        results[i] = {(int)i, flow, 0, 0, false};
+        if (flow > 0) pending.push_back((int)i);
+    }
+
+    atomic<size_t> next_job(0);
+    auto worker = [&]() {
+        size_t job;
+        while ((job = next_job++) < pending.size()) {
+            int i = pending[job];
+            results[i] = evaluate_outage(base_graph, base_potentials, i, get<0>(connections[i]), edge_index[i], s, t);
+        }
+    };
+
+    size_t num_threads = max(1u, thread::hardware_concurrency());
+    num_threads = min(num_threads, pending.size());
+    vector<thread> workers;
+    for (size_t i = 0; i < num_threads; ++i) workers.emplace_back(worker);
+    for (auto& w : workers) w.join();
+
+    return results;
+}
+
+/**
+ * Prints the N-1 report, worst outages (most unmet demand) first.
+ */
+void report_pipe_outages(const vector<Place>& places, const ConnectionList& connections,
+                         const WaterNetwork& graph, int s, int t) {
+    int base_flow, base_cost;
+    compute_plan_totals(graph, s, base_flow, base_cost);
+
+    vector<OutageResult> results = evaluate_pipe_outages(graph, connections, s, t);
+
+    vector<OutageResult> ranked;
+    vector<OutageResult> failed;
+    vector<OutageResult> skipped;
+    for (const auto& r : results) {
+        if (r.evaluated) ranked.push_back(r);
+        else if (r.base_pipe_flow > 0) failed.push_back(r);
+        else skipped.push_back(r);
+    }
+    // Rank by unmet-demand impact, then by cost change
+    stable_sort(ranked.begin(), ranked.end(), [](const OutageResult& a, const OutageResult& b) {
+        if (a.flow_achieved != b.flow_achieved) return a.flow_achieved < b.flow_achieved;
+        return a.total_cost > b.total_cost;
+    });
+
+    auto pipe_name = [&](const OutageResult& r) {
+        const auto& conn = connections[r.connection_index];
+        return places[get<0>(conn)].name + " -> " + places[get<1>(conn)].name;
+    };
+
+    cout << "\n--- N-1 PIPE OUTAGE CONTINGENCY REPORT ---\n";
+    cout << "Base Plan: " << base_flow << " KL distributed at $" << base_cost << endl;
+    cout << "Pipes evaluated: " << ranked.size() << " of " << connections.size()
+         << " (" << skipped.size() << " carry no flow and cannot change the plan)" << endl;
+    for (const auto& r : failed) {
+        cerr << "Warning: Could not evaluate outage of pipe " << pipe_name(r)
+             << " (its flow could not be rerouted from the base plan)" << endl;
+    }
+
+    if (ranked.empty() && skipped.empty()) {
+        cout << "------------------------------------------" << endl;
+        return;
+    }
+
+    cout << setw(5) << "Rank" << setw(30) << "Pipe" << setw(12) << "Pipe Flow"
+         << setw(14) << "Unmet Change" << setw(14) << "Cost Change" << endl;
+    for (size_t i = 0; i < ranked.size(); ++i) {
+        const auto& r = ranked[i];
+        cout << setw(5) << i + 1 << setw(30) << pipe_name(r) << setw(12) << r.base_pipe_flow
+             << setw(14) << base_flow - r.flow_achieved << setw(14) << r.total_cost - base_cost << endl;
+    }
+    // Pipes without flow: losing them changes nothing, so they are safe to take out of service
+    for (const auto& r : skipped) {
+        cout << setw(5) << "-" << setw(30) << pipe_name(r) << setw(12) << 0
+             << setw(14) << 0 << setw(14) << 0 << "  (skipped: no flow)" << endl;
+    }
+    cout << "------------------------------------------" << endl;
+}
@@ -7,7 +7,9 @@
 void add_edge(WaterNetwork& graph, int u, int v, int cap, int cost) {
     // 1. Forward edge (u -> v)
     // Stores the index of the soon-to-be-added reverse edge.
-    Edge forward = {v, cap, 0, cost, (int)graph[v].size()}; 
+    // For a self-loop (u == v) both land in the same list, after the forward edge.
+    int reverse_idx = (int)graph[v].size() + (u == v ? 1 : 0);
+    Edge forward = {v, cap, 0, cost, reverse_idx}; 
     graph[u].push_back(forward);
 
     // 2. Backward (Residual) edge (v -> u)
@@ -15,3 +17,72 @@ void add_edge(WaterNetwork& graph, int u, int v, int cap, int cost) {
     Edge backward = {u, 0, 0, -cost, (int)graph[u].size() - 1}; 
     graph[v].push_back(backward);
 }
+
+/**
+ * Adds the pipes first, then the super source / super sink edges, so the adjacency
+ * layout depends only on the order of places and connections.
+ */
+WaterNetwork build_water_network(const vector<Place>& places, const ConnectionList& connections) {
+    const int SUPER_SOURCE = places.size();
+    const int SUPER_SINK = places.size() + 1;
+    WaterNetwork graph(places.size() + 2);
+
+    for (const auto& conn : connections) {
+        add_edge(graph, get<0>(conn), get<1>(conn), get<2>(conn), get<3>(conn));
+    }
+
+    for (const auto& p : places) {
+        if (p.deficit_or_surplus > 0) { // Surplus node: Connect to Super Source
+            add_edge(graph, SUPER_SOURCE, p.id, p.deficit_or_surplus, 0);
+        } else if (p.deficit_or_surplus < 0) { // Deficit node: Connect to Super Sink
+            // Priority Cost: Lower priority (5) means higher cost/penalty
+            int priority_cost = (p.priority_level - 1) * PRIORITY_PENALTY;
+            add_edge(graph, p.id, SUPER_SINK, -p.deficit_or_surplus, priority_cost);
+        }
+    }
+    return graph;
+}
+
+/**
+ * Only positive flows are counted, i.e. forward edges; reverse entries mirror them.
+ */
+void compute_plan_totals(const WaterNetwork& graph, int s, int& total_flow, int& total_cost) {
+    total_flow = 0;
+    total_cost = 0;
+    for (const auto& edge : graph[s]) {
+        if (edge.flow > 0) total_flow += edge.flow;
+    }
+    for (const auto& adjacency : graph) {
+        for (const auto& edge : adjacency) {
+            if (edge.flow > 0) total_cost += edge.flow * edge.cost;
+        }
+    }
+}
+
+static bool flow_carrying_dfs(const WaterNetwork& graph, int u, int target,
+                              vector<bool>& visited, vector<pair<int, int>>& path) {
+    if (u == target) return true;
+    visited[u] = true;
+
+    for (size_t i = 0; i < graph[u].size(); ++i) {
+        const auto& edge = graph[u][i];
+        // Reverse edges never carry positive flow, so this only follows forward edges
+        if (edge.flow > 0 && !visited[edge.to_place]) {
+            path.push_back({u, (int)i});
+            if (flow_carrying_dfs(graph, edge.to_place, target, visited, path)) return true;
+            path.pop_back();
+        }
+    }
+    return false;
+}
+
+/**
+ * Depth-first search over edges with positive flow.
+ */
+bool find_flow_carrying_path(const WaterNetwork& graph, int u, int target,
+                             vector<pair<int, int>>& path, int avoid) {
+    vector<bool> visited(graph.size(), false);
+    if (avoid >= 0) visited[avoid] = true;
+    path.clear();
+    return flow_carrying_dfs(graph, u, target, visited, path);
+}
@@ -1,6 +1,7 @@
 #include "mcmf_solver.h"
 #include <algorithm>
 #include <iostream>
+#include <queue>
 
 using namespace std;
 
@@ -93,3 +94,187 @@ int min_cost_max_flow(WaterNetwork& graph, int s, int t, int& max_flow_result) {
 
     return total_cost;
 }
+
+/**
+ * Runs Bellman-Ford from a virtual root (every node starts at distance 0).
+ * Returns a node on a negative-cost residual cycle, or -1 if none exists.
+ */
+static int find_negative_cycle(const WaterNetwork& graph, vector<int>& dist,
+                               vector<int>& parent_v, vector<int>& parent_e) {
+    int N = graph.size();
+    fill(dist.begin(), dist.end(), 0);
+    fill(parent_v.begin(), parent_v.end(), -1);
+    fill(parent_e.begin(), parent_e.end(), -1);
+
+    int last_updated = -1;
+    for (int i = 0; i < N; ++i) {
+        last_updated = -1;
+        for (int u = 0; u < N; ++u) {
+            for (size_t edge_idx = 0; edge_idx < graph[u].size(); ++edge_idx) {
+                const auto& edge = graph[u][edge_idx];
+                if (edge.capacity - edge.flow <= 0) continue;
+
+                int v = edge.to_place;
+                if (dist[v] > dist[u] + edge.cost) {
+                    dist[v] = dist[u] + edge.cost;
+                    parent_v[v] = u;
+                    parent_e[v] = (int)edge_idx;
+                    last_updated = v;
+                }
+            }
+        }
+        if (last_updated == -1) return -1;
+    }
+
+    // Still relaxing after N passes: walk back N steps to land inside the cycle
+    int x = last_updated;
+    for (int i = 0; i < N; ++i) x = parent_v[x];
+    return x;
+}
+
+/**
+ * Shortest residual distances from a virtual root, so every residual edge
+ * has a non-negative reduced cost (cost + p[u] - p[v]).
+ */
+vector<int> compute_node_potentials(const WaterNetwork& graph) {
+    int N = graph.size();
+    vector<int> dist(N), parent_v(N), parent_e(N);
+    find_negative_cycle(graph, dist, parent_v, parent_e);
+    return dist;
+}
+
+// --- Dijkstra on Reduced Costs ---
+
+const long long UNREACHED = LLONG_MAX;
+
+/**
+ * Dijkstra from one or more sources over residual edges, using reduced costs
+ * (never negative for valid potentials). Stops once a node accepted by is_target
+ * is settled and returns it (-1 if none is reachable). Potentials are then shifted
+ * by min(dist, dist[target]), which keeps every reduced cost non-negative and makes
+ * the found path's reduced costs zero.
+ */
+template <typename TargetTest>
+static int dijkstra_reduced(const WaterNetwork& graph, const vector<int>& sources, TargetTest is_target,
+                            vector<long long>& potentials, vector<int>& parent_v, vector<int>& parent_e) {
+    int N = graph.size();
+    vector<long long> dist(N, UNREACHED);
+    vector<bool> settled(N, false);
+    priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<pair<long long, int>>> pq;
+
+    for (int src : sources) {
+        dist[src] = 0;
+        parent_v[src] = -1;
+        pq.push({0, src});
+    }
+
+    int target = -1;
+    while (!pq.empty()) {
+        auto [d, u] = pq.top();
+        pq.pop();
+        if (settled[u]) continue;
+        settled[u] = true;
+        if (is_target(u)) {
+            target = u;
+            break;
+        }
+
+        for (size_t edge_idx = 0; edge_idx < graph[u].size(); ++edge_idx) {
+            const auto& edge = graph[u][edge_idx];
+            int v = edge.to_place;
+            if (edge.capacity - edge.flow <= 0 || settled[v]) continue;
+
+            long long reduced = edge.cost + potentials[u] - potentials[v];
+            if (d + reduced < dist[v]) {
+                dist[v] = d + reduced;
+                parent_v[v] = u;
+                parent_e[v] = (int)edge_idx;
+                pq.push({dist[v], v});
+            }
+        }
+    }
+    if (target == -1) return -1;
+
+    // Unsettled nodes are at least dist[target] away, so they all shift by dist[target]
+    long long reach = dist[target];
+    for (int u = 0; u < N; ++u) {
+        potentials[u] += settled[u] ? dist[u] : reach;
+    }
+    return target;
+}
+
+// Smallest residual capacity on the parent path ending at v, capped at limit.
+static int path_bottleneck(const WaterNetwork& graph, int v, int limit,
+                           const vector<int>& parent_v, const vector<int>& parent_e) {
+    while (parent_v[v] != -1) {
+        const auto& edge = graph[parent_v[v]][parent_e[v]];
+        limit = min(limit, edge.capacity - edge.flow);
+        v = parent_v[v];
+    }
+    return limit;
+}
+
+// Pushes amount along the parent path ending at v; returns the path's start node.
+static int augment_path(WaterNetwork& graph, int v, int amount,
+                        const vector<int>& parent_v, const vector<int>& parent_e) {
+    while (parent_v[v] != -1) {
+        int u = parent_v[v];
+        auto& edge = graph[u][parent_e[v]];
+        edge.flow += amount;
+        graph[v][edge.reverse_edge].flow -= amount;
+        v = u;
+    }
+    return v;
+}
+
+/**
+ * Successive shortest paths on a pseudoflow. Each push follows a shortest path in
+ * reduced costs, so the flow stays optimal for its value throughout and no
+ * cycle-canceling is ever needed.
+ */
+bool rebalance_and_augment(WaterNetwork& graph, int s, int t, vector<long long>& potentials) {
+    int N = graph.size();
+    vector<int> parent_v(N, -1), parent_e(N, -1);
+
+    // Excess (inflow minus outflow) at every place; s and t are exempt from conservation
+    vector<long long> excess(N, 0);
+    for (int u = 0; u < N; ++u) {
+        for (const auto& edge : graph[u]) excess[u] -= edge.flow;
+    }
+    excess[s] = excess[t] = 0;
+
+    // 1. Send each excess to the nearest place with a shortage, or to s / t
+    for (int x = 0; x < N; ++x) {
+        while (excess[x] > 0) {
+            auto absorbs = [&](int v) { return v == s || v == t || excess[v] < 0; };
+            int y = dijkstra_reduced(graph, {x}, absorbs, potentials, parent_v, parent_e);
+            if (y == -1) return false;
+
+            long long wanted = (y == s || y == t) ? excess[x] : min(excess[x], -excess[y]);
+            int amount = path_bottleneck(graph, y, (int)min<long long>(wanted, INT_MAX), parent_v, parent_e);
+            augment_path(graph, y, amount, parent_v, parent_e);
+            excess[x] -= amount;
+            if (y != s && y != t) excess[y] += amount;
+        }
+    }
+
+    // 2. Fill each remaining shortage from s (more supply) or t (less delivered)
+    for (int y = 0; y < N; ++y) {
+        while (excess[y] < 0) {
+            auto is_y = [&](int v) { return v == y; };
+            if (dijkstra_reduced(graph, {s, t}, is_y, potentials, parent_v, parent_e) == -1) return false;
+
+            int amount = path_bottleneck(graph, y, (int)min<long long>(-excess[y], INT_MAX), parent_v, parent_e);
+            augment_path(graph, y, amount, parent_v, parent_e);
+            excess[y] += amount;
+        }
+    }
+
+    // 3. Balanced and optimal for its value: augment to maximum flow
+    auto is_t = [&](int v) { return v == t; };
+    while (dijkstra_reduced(graph, {s}, is_t, potentials, parent_v, parent_e) != -1) {
+        int amount = path_bottleneck(graph, t, INT_MAX, parent_v, parent_e);
+        augment_path(graph, t, amount, parent_v, parent_e);
+    }
+    return true;
+}
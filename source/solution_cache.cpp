@@ -0,0 +1,340 @@
+#include "solution_cache.h"
+#include "graph_ops.h"
+#include "mcmf_solver.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+using namespace std;
+
+// --- Hashing ---
+
+// 64-bit FNV-1a over a serialized description of the network.
+static uint64_t fnv1a_64(const string& data) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void write_solver_parameters(ostringstream& out) {
+    out << "solver SSP-BellmanFord v" << SOLUTION_CACHE_VERSION
+        << " penalty " << PRIORITY_PENALTY << "\n";
+}
+
+/**
+ * Serializes places, connections and solver parameters, one record per line.
+ */
+string describe_network_input(const vector<Place>& places, const ConnectionList& connections) {
+    ostringstream out;
+    write_solver_parameters(out);
+    for (const auto& p : places) {
+        out << "P " << p.id << ' ' << p.name << ' ' << p.deficit_or_surplus << ' '
+            << p.priority_level << ' ' << p.soil_type << "\n";
+    }
+    for (const auto& conn : connections) {
+        out << "C " << get<0>(conn) << ' ' << get<1>(conn) << ' '
+            << get<2>(conn) << ' ' << get<3>(conn) << "\n";
+    }
+    return out.str();
+}
+
+/**
+ * Hashes the serialized network input.
+ */
+uint64_t compute_content_key(const string& network_input) {
+    return fnv1a_64(network_input);
+}
+
+/**
+ * Hashes the network shape only. Capacities and balance amounts are left out,
+ * but everything that decides the adjacency layout and edge costs is kept.
+ */
+uint64_t compute_topology_key(const vector<Place>& places, const ConnectionList& connections) {
+    ostringstream out;
+    write_solver_parameters(out);
+    for (const auto& p : places) {
+        int role = (p.deficit_or_surplus > 0) ? 1 : (p.deficit_or_surplus < 0 ? -1 : 0);
+        out << "P " << role;
+        if (role < 0) out << ' ' << p.priority_level; // Priority sets the super sink edge cost
+        out << "\n";
+    }
+    for (const auto& conn : connections) {
+        out << "C " << get<0>(conn) << ' ' << get<1>(conn) << ' ' << get<3>(conn) << "\n";
+    }
+    return fnv1a_64(out.str());
+}
+
+// --- File I/O ---
+
+static string key_to_hex(uint64_t key) {
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)key);
+    return buffer;
+}
+
+static string content_path(const string& cache_dir, uint64_t key) {
+    return cache_dir + "/" + key_to_hex(key) + ".sol";
+}
+
+static string topology_path(const string& cache_dir, uint64_t key) {
+    return cache_dir + "/topo_" + key_to_hex(key) + ".sol";
+}
+
+// Parses a 64-bit hex key, rejecting anything that is not entirely hex digits.
+static bool parse_hex_key(const string& text, uint64_t& key) {
+    if (text.empty() || text.size() > 16) return false;
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long value = strtoull(text.c_str(), &end, 16);
+    if (errno != 0 || end != text.c_str() + text.size()) return false;
+    key = value;
+    return true;
+}
+
+/**
+ * Reads a cache entry. Any damage (bad keys, absurd sizes, truncation) makes it
+ * a cache miss rather than an error, so the caller just solves normally.
+ */
+static bool read_solution_file(const string& path, CachedSolution& solution) {
+    ifstream file(path);
+    if (!file.is_open()) return false;
+
+    string magic, label, content_hex, topology_hex;
+    int version;
+    size_t num_nodes;
+    if (!(file >> magic >> version) || magic != "H2O_SOLUTION" || version != SOLUTION_CACHE_VERSION) {
+        return false;
+    }
+    if (!(file >> label >> content_hex >> label >> topology_hex)) return false;
+    if (!parse_hex_key(content_hex, solution.content_key) ||
+        !parse_hex_key(topology_hex, solution.topology_key)) {
+        return false;
+    }
+    if (!(file >> label >> solution.total_flow_achieved >> solution.min_total_cost)) return false;
+
+    // The exact input text this entry was solved for, prefixed by its length
+    size_t input_length;
+    if (!(file >> label >> input_length) || input_length > MAX_CACHED_INPUT_BYTES) return false;
+    file.get(); // Newline after the length
+    solution.network_input.assign(input_length, '\0');
+    if (!file.read(&solution.network_input[0], input_length)) return false;
+
+    if (!(file >> label >> num_nodes) || num_nodes > MAX_CACHED_NODES) return false;
+
+    solution.flows.assign(num_nodes, {});
+    solution.potentials.assign(num_nodes, 0);
+
+    // One line per node: potential, adjacency size, then the flow on each entry
+    for (size_t u = 0; u < num_nodes; ++u) {
+        size_t degree;
+        if (!(file >> solution.potentials[u] >> degree) || degree > MAX_CACHED_DEGREE) return false;
+        for (size_t i = 0; i < degree; ++i) {
+            int flow;
+            if (!(file >> flow)) return false;
+            solution.flows[u].push_back(flow);
+        }
+    }
+    return true;
+}
+
+static bool write_solution_file(const string& path, const CachedSolution& solution) {
+    // Write to a temporary file first so readers never see a half-written entry.
+    // The name is unique per writer, since several tools may share the cache directory.
+    random_device rd;
+    uint64_t suffix = ((uint64_t)rd() << 32) ^ rd();
+    string tmp_path = path + ".tmp." + key_to_hex(suffix);
+    error_code ec;
+    {
+        ofstream file(tmp_path);
+        if (!file.is_open()) return false;
+
+        file << "H2O_SOLUTION " << SOLUTION_CACHE_VERSION << "\n";
+        file << "content " << key_to_hex(solution.content_key)
+             << " topology " << key_to_hex(solution.topology_key) << "\n";
+        file << "summary " << solution.total_flow_achieved << ' ' << solution.min_total_cost << "\n";
+        file << "input " << solution.network_input.size() << "\n" << solution.network_input;
+        file << "nodes " << solution.flows.size() << "\n";
+        for (size_t u = 0; u < solution.flows.size(); ++u) {
+            file << solution.potentials[u] << ' ' << solution.flows[u].size();
+            for (int f : solution.flows[u]) file << ' ' << f;
+            file << "\n";
+        }
+        if (!file) {
+            file.close();
+            filesystem::remove(tmp_path, ec);
+            return false;
+        }
+    }
+
+    filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        filesystem::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Looks up a solution by content key. The stored input text must match exactly,
+ * so a hash collision or a renamed file is a miss rather than a wrong plan.
+ */
+bool load_exact_solution(const string& cache_dir, const string& network_input, CachedSolution& solution) {
+    uint64_t content_key = compute_content_key(network_input);
+    return read_solution_file(content_path(cache_dir, content_key), solution)
+        && solution.content_key == content_key
+        && solution.network_input == network_input;
+}
+
+/**
+ * Looks up the latest solution stored for a topology.
+ */
+bool load_warm_start_solution(const string& cache_dir, uint64_t topology_key, CachedSolution& solution) {
+    return read_solution_file(topology_path(cache_dir, topology_key), solution)
+        && solution.topology_key == topology_key;
+}
+
+/**
+ * Writes the solution under its content key and refreshes the topology entry.
+ */
+bool save_solution(const string& cache_dir, const CachedSolution& solution) {
+    error_code ec;
+    filesystem::create_directories(cache_dir, ec);
+    if (ec) {
+        cerr << "Warning: Could not create cache directory " << cache_dir << ": " << ec.message() << endl;
+        return false;
+    }
+
+    if (!write_solution_file(content_path(cache_dir, solution.content_key), solution) ||
+        !write_solution_file(topology_path(cache_dir, solution.topology_key), solution)) {
+        cerr << "Warning: Could not write solution cache in " << cache_dir << endl;
+        return false;
+    }
+    return true;
+}
+
+// --- Applying Cached Flows ---
+
+static bool layout_matches(const WaterNetwork& graph, const CachedSolution& solution) {
+    if (graph.size() != solution.flows.size()) return false;
+    for (size_t u = 0; u < graph.size(); ++u) {
+        if (graph[u].size() != solution.flows[u].size()) return false;
+    }
+    return true;
+}
+
+// Overwrites every entry's flow with the cached one (layouts must already match).
+static void apply_flows(WaterNetwork& graph, const CachedSolution& solution) {
+    for (size_t u = 0; u < graph.size(); ++u) {
+        for (size_t i = 0; i < graph[u].size(); ++i) {
+            graph[u][i].flow = solution.flows[u][i];
+        }
+    }
+}
+
+/**
+ * Checks that the cached flows form a valid plan on this graph: within capacity,
+ * mirrored on reverse entries, conserved at every place, and matching the summary.
+ */
+static bool cached_flows_are_valid(const WaterNetwork& graph, const CachedSolution& solution, int s, int t) {
+    vector<long long> net_outflow(graph.size(), 0);
+    long long total_cost = 0;
+
+    for (size_t u = 0; u < graph.size(); ++u) {
+        for (size_t i = 0; i < graph[u].size(); ++i) {
+            const auto& edge = graph[u][i];
+            int flow = solution.flows[u][i];
+            int reverse_flow = solution.flows[edge.to_place][edge.reverse_edge];
+
+            if (flow > edge.capacity || flow != -reverse_flow) return false;
+            if (edge.capacity > 0 && flow < 0) return false; // Forward edges never run backwards
+
+            net_outflow[u] += flow;
+            if (flow > 0) total_cost += (long long)flow * edge.cost;
+        }
+    }
+
+    for (size_t u = 0; u < graph.size(); ++u) {
+        if ((int)u != s && (int)u != t && net_outflow[u] != 0) return false;
+    }
+    return net_outflow[s] == solution.total_flow_achieved && total_cost == solution.min_total_cost;
+}
+
+/**
+ * Copies every adjacency entry's flow from the cache onto the graph.
+ */
+bool apply_cached_flows(WaterNetwork& graph, const CachedSolution& solution, int s, int t) {
+    if (!layout_matches(graph, solution) || !cached_flows_are_valid(graph, solution, s, t)) return false;
+
+    apply_flows(graph, solution);
+    return true;
+}
+
+/**
+ * Captures the flow on every adjacency entry plus the final node potentials.
+ */
+void capture_solution_flows(const WaterNetwork& graph, CachedSolution& solution) {
+    solution.flows.clear();
+    for (const auto& adjacency : graph) {
+        vector<int> node_flows;
+        for (const auto& edge : adjacency) node_flows.push_back(edge.flow);
+        solution.flows.push_back(node_flows);
+    }
+    solution.potentials = compute_node_potentials(graph);
+}
+
+/**
+ * Starts from the cached flows clamped to the new capacities. Under the stored
+ * potentials, only edges whose capacity grew can have a negative reduced cost;
+ * saturating those makes every reduced cost non-negative again. The imbalances left
+ * by clamping and saturating are then routed with Dijkstra (rebalance_and_augment).
+ * The repair never trusts the cached flows or potentials for correctness, only for speed.
+ */
+bool warm_start_solve(WaterNetwork& graph, const CachedSolution& solution, int s, int t,
+                      int& total_flow, int& total_cost) {
+    if (!layout_matches(graph, solution) || solution.potentials.size() != graph.size()) return false;
+
+    // 1. Cached flows, clamped to the new capacities
+    for (auto& adjacency : graph) {
+        for (auto& edge : adjacency) edge.flow = 0;
+    }
+    for (size_t u = 0; u < graph.size(); ++u) {
+        for (size_t i = 0; i < graph[u].size(); ++i) {
+            auto& edge = graph[u][i];
+            int flow = min(solution.flows[u][i], max(edge.capacity, 0));
+            if (flow <= 0) continue;
+            edge.flow = flow;
+            graph[edge.to_place][edge.reverse_edge].flow = -flow;
+        }
+    }
+
+    // 2. Saturate residual edges with negative reduced cost
+    vector<long long> potentials(solution.potentials.begin(), solution.potentials.end());
+    for (size_t u = 0; u < graph.size(); ++u) {
+        for (auto& edge : graph[u]) {
+            int residual = edge.capacity - edge.flow;
+            if (residual > 0 && edge.cost + potentials[u] - potentials[edge.to_place] < 0) {
+                edge.flow += residual;
+                graph[edge.to_place][edge.reverse_edge].flow -= residual;
+            }
+        }
+    }
+
+    // 3. Route the imbalances and augment to maximum flow
+    if (!rebalance_and_augment(graph, s, t, potentials)) {
+        for (auto& adjacency : graph) {
+            for (auto& edge : adjacency) edge.flow = 0;
+        }
+        return false;
+    }
+    compute_plan_totals(graph, s, total_flow, total_cost);
+    return true;
+}